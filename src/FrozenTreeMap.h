@@ -0,0 +1,242 @@
+#ifndef AISDI_MAPS_FROZENTREEMAP_H
+#define AISDI_MAPS_FROZENTREEMAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace aisdi {
+
+    // Immutable sorted index, usually made by TreeMap::freeze().
+    // Keys are kept in Eytzinger (BFS) order in one contiguous array - node k has children 2k and 2k + 1,
+    // index 0 is unused and stands for end() - so the top levels of every search share a few cache lines.
+    template <typename KeyType, typename ValueType>
+    class FrozenTreeMap {
+    public:
+        using key_type = KeyType;
+        using mapped_type = ValueType;
+        using size_type = std::size_t;
+        // Keys and values live in separate arrays, so iterators hand out pairs of references
+        using value_type = std::pair<const key_type&, const mapped_type&>;
+        using reference = value_type;
+        using const_reference = value_type;
+
+        class ConstIterator;
+        using iterator = ConstIterator;
+        using const_iterator = ConstIterator;
+
+        FrozenTreeMap() : keys(1), values(1) {}
+
+        // Builds index from size items given in ascending key order
+        template <typename InputIterator>
+        FrozenTreeMap(InputIterator first, size_type size) : keys(size + 1), values(size + 1) {
+            fill(first, 1);
+        }
+
+        bool isEmpty() const {
+            return getSize() == 0;
+        }
+
+        size_type getSize() const {
+            return keys.size() - 1;
+        }
+
+        const mapped_type& valueOf(const key_type& key) const {
+            auto index = findIndex(key);
+            if (index == 0) {
+                throw std::out_of_range("Key not in map");
+            }
+            return values[index];
+        }
+
+        const_iterator find(const key_type& key) const {
+            return const_iterator(*this, findIndex(key));
+        }
+
+        // First item whose key is not less than the given one
+        const_iterator lowerBound(const key_type& key) const {
+            return const_iterator(*this, lowerBoundIndex(key));
+        }
+
+        const_iterator cbegin() const {
+            size_type index = isEmpty() ? 0 : 1;
+            while (2 * index <= getSize()) {
+                index *= 2;
+            }
+            return const_iterator(*this, index);
+        }
+
+        const_iterator cend() const {
+            return const_iterator(*this, 0);
+        }
+
+        const_iterator begin() const {
+            return cbegin();
+        }
+
+        const_iterator end() const {
+            return cend();
+        }
+
+    private:
+        std::vector<key_type> keys;
+        std::vector<mapped_type> values;
+
+        template <typename InputIterator>
+        void fill(InputIterator& it, size_type index) {
+            if (index > getSize()) {
+                return;
+            }
+            fill(it, 2 * index);
+            keys[index] = it->first;
+            values[index] = it->second;
+            ++it;
+            fill(it, 2 * index + 1);
+        }
+
+        size_type lowerBoundIndex(const key_type& key) const {
+            const size_type size = getSize();
+            const key_type* data = keys.data();
+            size_type index = 1;
+            while (index <= size) {
+#if defined(__GNUC__)
+                // Four grandchildren are adjacent - fetch them while this level is being compared
+                __builtin_prefetch(data + std::min(4 * index, size));
+#endif
+                index = 2 * index + (data[index] < key);
+            }
+            // Path ended with some right turns after the last left one - undo them and the left turn
+            return index >> countTrailingOnes(index) >> 1;
+        }
+
+        size_type findIndex(const key_type& key) const {
+            auto index = lowerBoundIndex(key);
+            return index != 0 && !(key < keys[index]) ? index : 0;
+        }
+
+        static unsigned countTrailingOnes(size_type index) {
+#if defined(__GNUC__)
+            return __builtin_ctzll(~static_cast<unsigned long long>(index));
+#else
+            unsigned count = 0;
+            while (index & 1) {
+                index >>= 1;
+                ++count;
+            }
+            return count;
+#endif
+        }
+    };
+
+    template <typename KeyType, typename ValueType>
+    class FrozenTreeMap<KeyType, ValueType>::ConstIterator {
+    public:
+        using reference = typename FrozenTreeMap::const_reference;
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type = typename FrozenTreeMap::value_type;
+        using difference_type = std::ptrdiff_t;
+
+        // operator-> has to point at a pair which exists only as long as the expression
+        struct pointer {
+            value_type item;
+
+            const value_type* operator->() const {
+                return &item;
+            }
+        };
+
+        friend class FrozenTreeMap;
+
+        explicit ConstIterator(const FrozenTreeMap& map, size_type index) : map(&map), index(index) {}
+
+        ConstIterator& operator++() {
+            if (index == 0) {
+                throw std::out_of_range("Incrementing end iterator");
+            }
+            if (2 * index + 1 <= map->getSize()) {
+                // Leftmost node of the right subtree
+                index = 2 * index + 1;
+                while (2 * index <= map->getSize()) {
+                    index *= 2;
+                }
+            }
+            else {
+                // Climb while being a right child, then once more
+                index = index >> countTrailingOnes(index) >> 1;
+            }
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator ret = *this;
+            ++*this;
+            return ret;
+        }
+
+        ConstIterator& operator--() {
+            size_type previous;
+            if (index == 0) {
+                // Rightmost node
+                previous = map->isEmpty() ? 0 : 1;
+                while (2 * previous + 1 <= map->getSize()) {
+                    previous = 2 * previous + 1;
+                }
+            }
+            else if (2 * index <= map->getSize()) {
+                // Rightmost node of the left subtree
+                previous = 2 * index;
+                while (2 * previous + 1 <= map->getSize()) {
+                    previous = 2 * previous + 1;
+                }
+            }
+            else {
+                // Climb while being a left child, then once more
+                previous = index;
+                while ((previous & 1) == 0) {
+                    previous >>= 1;
+                }
+                previous >>= 1;
+            }
+            if (previous == 0) {
+                throw std::out_of_range("Decrementing begin iterator");
+            }
+            index = previous;
+            return *this;
+        }
+
+        ConstIterator operator--(int) {
+            ConstIterator ret = *this;
+            --*this;
+            return ret;
+        }
+
+        reference operator*() const {
+            if (index == 0) {
+                throw std::out_of_range("Dereferencing end iterator");
+            }
+            return value_type(map->keys[index], map->values[index]);
+        }
+
+        pointer operator->() const {
+            return pointer{ **this };
+        }
+
+        bool operator==(const ConstIterator& other) const {
+            return index == other.index;
+        }
+
+        bool operator!=(const ConstIterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        const FrozenTreeMap* map;
+        size_type index;
+    };
+
+}
+
+#endif /* AISDI_MAPS_FROZENTREEMAP_H */
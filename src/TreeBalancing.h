@@ -0,0 +1,317 @@
+#ifndef AISDI_MAPS_TREEBALANCING_H
+#define AISDI_MAPS_TREEBALANCING_H
+
+#include <algorithm>
+
+namespace aisdi {
+
+    // Balancing policies for TreeMap. Each one owns the `rank` field of tree nodes and is notified
+    // after a leaf was attached and after a node was unhooked from the tree:
+    //   afterInsert(tree, node)                  - node is a freshly attached leaf (rank 0)
+    //   afterRemove(tree, child, parent, rank)   - child (possibly null) took place of a removed node
+    //                                              under parent, rank is what that place has lost
+    // Rotations are done with tree.rotateLeft/rotateRight, which only restructure the tree.
+
+    // Strict height balance - the shallowest trees, the most rotations on deletion.
+    // Rank is the height of the subtree (-1 for null).
+    class AvlBalance {
+    public:
+        template <typename Tree>
+        static void afterInsert(Tree& tree, typename Tree::node_pointer node) {
+            rebalance(tree, node->parent);
+        }
+
+        template <typename Tree>
+        static void afterRemove(Tree& tree, typename Tree::node_pointer, typename Tree::node_pointer parent,
+                                int) {
+            rebalance(tree, parent);
+        }
+
+    private:
+        template <typename Node>
+        static int getHeight(Node* n) {
+            return n == nullptr ? -1 : n->rank;
+        }
+
+        template <typename Node>
+        static int getBalance(Node* n) {
+            return getHeight(n->rightChild) - getHeight(n->leftChild);
+        }
+
+        template <typename Node>
+        static void updateHeight(Node* n) {
+            n->rank = 1 + std::max(getHeight(n->leftChild), getHeight(n->rightChild));
+        }
+
+        template <typename Tree>
+        static typename Tree::node_pointer rotateLeft(Tree& tree, typename Tree::node_pointer n) {
+            auto newRoot = tree.rotateLeft(n);
+            updateHeight(n);
+            updateHeight(newRoot);
+            return newRoot;
+        }
+
+        template <typename Tree>
+        static typename Tree::node_pointer rotateRight(Tree& tree, typename Tree::node_pointer n) {
+            auto newRoot = tree.rotateRight(n);
+            updateHeight(n);
+            updateHeight(newRoot);
+            return newRoot;
+        }
+
+        // Walks up from balanceRoot, stopping as soon as a subtree keeps its previous height
+        template <typename Tree>
+        static void rebalance(Tree& tree, typename Tree::node_pointer balanceRoot) {
+            while (balanceRoot != nullptr) {
+                auto previousHeight = balanceRoot->rank;
+                updateHeight(balanceRoot);
+                auto balance = getBalance(balanceRoot);
+
+                if (balance == -2) {
+                    if (getBalance(balanceRoot->leftChild) > 0) {
+                        rotateLeft(tree, balanceRoot->leftChild);
+                    }
+                    balanceRoot = rotateRight(tree, balanceRoot);
+                }
+                else if (balance == 2) {
+                    if (getBalance(balanceRoot->rightChild) < 0) {
+                        rotateRight(tree, balanceRoot->rightChild);
+                    }
+                    balanceRoot = rotateLeft(tree, balanceRoot);
+                }
+
+                if (balanceRoot->rank == previousHeight) {
+                    return;
+                }
+                balanceRoot = balanceRoot->parent;
+            }
+        }
+    };
+
+    // At most three rotations per deletion and two per insertion, trees up to twice as deep as optimal.
+    // Rank is the colour of the node.
+    class RedBlackBalance {
+    public:
+        static const int RED = 0;
+        static const int BLACK = 1;
+
+        template <typename Tree>
+        static void afterInsert(Tree& tree, typename Tree::node_pointer node) {
+            while (isRed(node->parent)) {
+                auto parent = node->parent;
+                auto grandparent = parent->parent;
+                if (parent == grandparent->leftChild) {
+                    auto uncle = grandparent->rightChild;
+                    if (isRed(uncle)) {
+                        parent->rank = uncle->rank = BLACK;
+                        grandparent->rank = RED;
+                        node = grandparent;
+                        continue;
+                    }
+                    if (node == parent->rightChild) {
+                        tree.rotateLeft(parent);
+                        parent = node;
+                    }
+                    tree.rotateRight(grandparent);
+                }
+                else {
+                    auto uncle = grandparent->leftChild;
+                    if (isRed(uncle)) {
+                        parent->rank = uncle->rank = BLACK;
+                        grandparent->rank = RED;
+                        node = grandparent;
+                        continue;
+                    }
+                    if (node == parent->leftChild) {
+                        tree.rotateRight(parent);
+                        parent = node;
+                    }
+                    tree.rotateLeft(grandparent);
+                }
+                parent->rank = BLACK;
+                grandparent->rank = RED;
+                break;
+            }
+            tree.root->rank = BLACK;
+        }
+
+        template <typename Tree>
+        static void afterRemove(Tree& tree, typename Tree::node_pointer node, typename Tree::node_pointer parent,
+                                int removedRank) {
+            if (removedRank == RED) {
+                return;
+            }
+
+            // node carries an extra black until it can be pushed onto a red node or the root
+            while (node != tree.root && !isRed(node)) {
+                if (node == parent->leftChild) {
+                    auto sibling = parent->rightChild;
+                    if (isRed(sibling)) {
+                        sibling->rank = BLACK;
+                        parent->rank = RED;
+                        tree.rotateLeft(parent);
+                        sibling = parent->rightChild;
+                    }
+                    if (!isRed(sibling->leftChild) && !isRed(sibling->rightChild)) {
+                        sibling->rank = RED;
+                        node = parent;
+                        parent = node->parent;
+                        continue;
+                    }
+                    if (!isRed(sibling->rightChild)) {
+                        sibling->leftChild->rank = BLACK;
+                        sibling->rank = RED;
+                        tree.rotateRight(sibling);
+                        sibling = parent->rightChild;
+                    }
+                    sibling->rank = parent->rank;
+                    parent->rank = BLACK;
+                    sibling->rightChild->rank = BLACK;
+                    tree.rotateLeft(parent);
+                }
+                else {
+                    auto sibling = parent->leftChild;
+                    if (isRed(sibling)) {
+                        sibling->rank = BLACK;
+                        parent->rank = RED;
+                        tree.rotateRight(parent);
+                        sibling = parent->leftChild;
+                    }
+                    if (!isRed(sibling->leftChild) && !isRed(sibling->rightChild)) {
+                        sibling->rank = RED;
+                        node = parent;
+                        parent = node->parent;
+                        continue;
+                    }
+                    if (!isRed(sibling->leftChild)) {
+                        sibling->rightChild->rank = BLACK;
+                        sibling->rank = RED;
+                        tree.rotateLeft(sibling);
+                        sibling = parent->leftChild;
+                    }
+                    sibling->rank = parent->rank;
+                    parent->rank = BLACK;
+                    sibling->leftChild->rank = BLACK;
+                    tree.rotateRight(parent);
+                }
+                node = tree.root;
+            }
+            if (node != nullptr) {
+                node->rank = BLACK;
+            }
+        }
+
+    private:
+        template <typename Node>
+        static bool isRed(Node* n) {
+            return n != nullptr && n->rank == RED;
+        }
+    };
+
+    // Weak AVL (Haeupler, Sen, Tarjan) - AVL shape for insert-only workloads, at most two rotations
+    // per deletion. Rank differences between a node and its children are 1 or 2, leaves have rank 0.
+    class WeakAvlBalance {
+    public:
+        template <typename Tree>
+        static void afterInsert(Tree& tree, typename Tree::node_pointer node) {
+            auto parent = node->parent;
+            // node is a 0-child of parent while their ranks are equal
+            while (parent != nullptr && parent->rank == node->rank) {
+                bool nodeIsLeft = parent->leftChild == node;
+                auto sibling = nodeIsLeft ? parent->rightChild : parent->leftChild;
+                if (parent->rank - getRank(sibling) == 1) {
+                    ++parent->rank;
+                    node = parent;
+                    parent = node->parent;
+                    continue;
+                }
+
+                auto inner = nodeIsLeft ? node->rightChild : node->leftChild;
+                if (node->rank - getRank(inner) == 2) {
+                    rotateUp(tree, node);
+                    --parent->rank;
+                }
+                else {
+                    rotateUp(tree, inner);
+                    rotateUp(tree, inner);
+                    ++inner->rank;
+                    --node->rank;
+                    --parent->rank;
+                }
+                return;
+            }
+        }
+
+        template <typename Tree>
+        static void afterRemove(Tree& tree, typename Tree::node_pointer node, typename Tree::node_pointer parent,
+                                int) {
+            if (parent == nullptr) {
+                return;
+            }
+            if (parent->leftChild == nullptr && parent->rightChild == nullptr && parent->rank == 1) {
+                // 2,2-leaf
+                --parent->rank;
+                node = parent;
+                parent = node->parent;
+            }
+
+            // node is a 3-child of parent while their ranks differ by 3
+            while (parent != nullptr && parent->rank - getRank(node) == 3) {
+                bool nodeIsLeft = parent->leftChild == node;
+                auto sibling = nodeIsLeft ? parent->rightChild : parent->leftChild;
+                if (parent->rank - sibling->rank == 2) {
+                    --parent->rank;
+                    node = parent;
+                    parent = node->parent;
+                    continue;
+                }
+                auto outer = nodeIsLeft ? sibling->rightChild : sibling->leftChild;
+                auto inner = nodeIsLeft ? sibling->leftChild : sibling->rightChild;
+                if (sibling->rank - getRank(outer) == 2 && sibling->rank - getRank(inner) == 2) {
+                    --parent->rank;
+                    --sibling->rank;
+                    node = parent;
+                    parent = node->parent;
+                    continue;
+                }
+
+                if (sibling->rank - getRank(outer) == 1) {
+                    rotateUp(tree, sibling);
+                    ++sibling->rank;
+                    --parent->rank;
+                    if (parent->leftChild == nullptr && parent->rightChild == nullptr) {
+                        --parent->rank;
+                    }
+                }
+                else {
+                    rotateUp(tree, inner);
+                    rotateUp(tree, inner);
+                    inner->rank += 2;
+                    --sibling->rank;
+                    parent->rank -= 2;
+                }
+                return;
+            }
+        }
+
+    private:
+        template <typename Node>
+        static int getRank(Node* n) {
+            return n == nullptr ? -1 : n->rank;
+        }
+
+        // Rotates n above its parent
+        template <typename Tree>
+        static void rotateUp(Tree& tree, typename Tree::node_pointer n) {
+            if (n->parent->leftChild == n) {
+                tree.rotateRight(n->parent);
+            }
+            else {
+                tree.rotateLeft(n->parent);
+            }
+        }
+    };
+
+}
+
+#endif /* AISDI_MAPS_TREEBALANCING_H */
@@ -4,11 +4,15 @@
 #include <cstddef>
 #include <initializer_list>
 #include <stdexcept>
+#include <tuple>
 #include <utility>
 
+#include "FrozenTreeMap.h"
+#include "TreeBalancing.h"
+
 namespace aisdi {
 
-    template <typename KeyType, typename ValueType>
+    template <typename KeyType, typename ValueType, typename BalancePolicy = AvlBalance>
     class TreeMap {
     public:
         using key_type = KeyType;
@@ -28,13 +32,25 @@ namespace aisdi {
             TreeNode* parent;
             TreeNode* leftChild;
             TreeNode* rightChild;
-            int height;
+            // In-order neighbours, so that iterators never have to climb parent chains
+            TreeNode* prev;
+            TreeNode* next;
+            // Owned by BalancePolicy - subtree height, colour or rank
+            int rank;
 
             TreeNode() : val(std::make_pair(key_type(), mapped_type())), parent(nullptr), leftChild(nullptr),
-                         rightChild(nullptr), height(0) {}
+                         rightChild(nullptr), prev(nullptr), next(nullptr), rank(0) {}
 
             TreeNode(value_type value, TreeNode* parent=nullptr) : val(value), parent(parent), leftChild(nullptr),
-                                                                   rightChild(nullptr), height(0) {}
+                                                                   rightChild(nullptr), prev(nullptr), next(nullptr),
+                                                                   rank(0) {}
+
+            template <typename... Args>
+            TreeNode(const key_type& key, Args&&... args)
+                    : val(std::piecewise_construct, std::forward_as_tuple(key),
+                          std::forward_as_tuple(std::forward<Args>(args)...)),
+                      parent(nullptr), leftChild(nullptr), rightChild(nullptr), prev(nullptr), next(nullptr),
+                      rank(0) {}
 
             key_type key() {
                 return val.first;
@@ -46,7 +62,7 @@ namespace aisdi {
         };
         using node_pointer = node*;
 
-        TreeMap() : root(nullptr), size(0) {}
+        TreeMap() : root(nullptr), minNode(nullptr), maxNode(nullptr), size(0), rotations(0) {}
 
         TreeMap(std::initializer_list<value_type> list) : TreeMap() {
             for (auto& val : list) {
@@ -60,10 +76,8 @@ namespace aisdi {
             }
         }
 
-        TreeMap(TreeMap&& other) {
-            this->root = other.root;
-            this->size = other.size;
-            other.root = nullptr;
+        TreeMap(TreeMap&& other) : TreeMap() {
+            takeTree(other);
         }
 
         ~TreeMap() {
@@ -86,9 +100,7 @@ namespace aisdi {
                 return *this;
             }
             clearTree();
-            this->root = other.root;
-            this->size = other.size;
-            other.root = nullptr;
+            takeTree(other);
             return *this;
         }
 
@@ -97,38 +109,31 @@ namespace aisdi {
         }
 
         mapped_type& operator[](const key_type& key) {
-            node_pointer* node_placeholder = &root;
             node_pointer parent = nullptr;
-
-            if (root == nullptr) {
-                // Tree empty -> creating new node
-                root = new TreeNode(std::make_pair(key, mapped_type()));
-                ++size;
-                return root->value();
-            }
-
-            while (*node_placeholder != nullptr && (*node_placeholder)->key() != key) {
-                parent = *node_placeholder;
-                if ((*node_placeholder)->key() > key) {
-                    node_placeholder = &(*node_placeholder)->leftChild;
-                }
-                else {
-                    node_placeholder = &(*node_placeholder)->rightChild;
-                }
+            bool asLeftChild = false;
+            node_pointer existing = root == nullptr ? nullptr : descend(root, key, parent, asLeftChild);
+            if (existing != nullptr) {
+                return existing->value();
             }
+            return attachNode(new TreeNode(std::make_pair(key, mapped_type())), parent, asLeftChild)->value();
+        }
 
-            if (*node_placeholder != nullptr) {
-                // Key found
-                return (*node_placeholder)->value();
+        // Inserts key with value constructed from args, starting the search at hint instead of root.
+        // Inserting right before hint (e.g. appending with hint == end()) costs amortized O(1),
+        // otherwise the search climbs from hint only as far as needed. Existing value is left untouched.
+        template <typename... Args>
+        iterator emplaceHint(const const_iterator& hint, const key_type& key, Args&&... args) {
+            node_pointer parent = nullptr;
+            bool asLeftChild = false;
+            node_pointer existing = findSlotFromHint(hint.currentNode, key, parent, asLeftChild);
+            if (existing != nullptr) {
+                return iterator(*this, existing);
             }
-            // Key not found -> creating new node
-            *node_placeholder = new TreeNode(std::make_pair(key, mapped_type()), parent);
-            // After rebalance node_placeholder might reference something else
-            node_pointer retVal = *node_placeholder;
-            ++size;
-            rebalance(parent);
+            return iterator(*this, attachNode(new TreeNode(key, std::forward<Args>(args)...), parent, asLeftChild));
+        }
 
-            return retVal->value();
+        iterator insert(const const_iterator& hint, const key_type& key, const mapped_type& value) {
+            return emplaceHint(hint, key, value);
         }
 
         const mapped_type& valueOf(const key_type& key) const {
@@ -177,46 +182,57 @@ namespace aisdi {
             }
 
             auto deletedNode = it.currentNode;
+            // Child and parent of the place in the tree which actually disappears
+            node_pointer child;
+            node_pointer parent;
+            int removedRank;
             if (deletedNode->leftChild != nullptr && deletedNode->rightChild != nullptr) {
-                // Node inside of the tree - swap with next value
-                iterator swappedNode = it;
-                ++swappedNode;
-//                it.currentNode->val = swappedNode.currentNode->val;
-                override(it.currentNode, swappedNode.currentNode);
-                deletedNode = swappedNode.currentNode;
-            }
-
-            auto parentOfDeleted = deletedNode->parent;
-            node_pointer* deletedNodePointer;
-            if (deletedNode->parent == nullptr) {
-                deletedNodePointer = &root;
-            }
-            else if (deletedNode->parent->leftChild == deletedNode) {
-                deletedNodePointer = &deletedNode->parent->leftChild;
-            }
-            else {
-                deletedNodePointer = &deletedNode->parent->rightChild;
-            }
-
-            if (deletedNode->leftChild == nullptr && deletedNode->rightChild == nullptr) {
-                // Deleting leaf
-                *deletedNodePointer = nullptr;
+                // Node inside of the tree - its successor has no left child, so it can be unhooked
+                // and put in place of the deleted node
+                auto successor = deletedNode->next;
+                child = successor->rightChild;
+                removedRank = successor->rank;
+                if (successor->parent == deletedNode) {
+                    parent = successor;
+                }
+                else {
+                    parent = successor->parent;
+                    replaceInParent(successor, successor->rightChild);
+                    successor->rightChild = deletedNode->rightChild;
+                    successor->rightChild->parent = successor;
+                }
+                replaceInParent(deletedNode, successor);
+                successor->leftChild = deletedNode->leftChild;
+                successor->leftChild->parent = successor;
+                successor->rank = deletedNode->rank;
             }
             else {
-                // Node has only one branch
-                auto branch = deletedNode->rightChild == nullptr ? deletedNode->leftChild : deletedNode->rightChild;
-                branch->parent = deletedNode->parent;
-                *deletedNodePointer = branch;
+                // Node has at most one branch
+                child = deletedNode->rightChild == nullptr ? deletedNode->leftChild : deletedNode->rightChild;
+                parent = deletedNode->parent;
+                removedRank = deletedNode->rank;
+                replaceInParent(deletedNode, child);
             }
+            unlinkNode(deletedNode);
             delete deletedNode;
             --size;
-            rebalance(parentOfDeleted);
+            BalancePolicy::afterRemove(*this, child, parent, removedRank);
         }
 
         size_type getSize() const {
             return size;
         }
 
+        // Read-only copy of the map laid out for fast searching
+        FrozenTreeMap<key_type, mapped_type> freeze() const {
+            return FrozenTreeMap<key_type, mapped_type>(cbegin(), size);
+        }
+
+        // Rotations done by BalancePolicy since the map was created
+        size_type getRotationCount() const {
+            return rotations;
+        }
+
         bool operator==(const TreeMap& other) const {
             if (size != other.size) {
                 return false;
@@ -235,7 +251,7 @@ namespace aisdi {
         }
 
         iterator begin() {
-            return iterator(*this, minElement());
+            return iterator(*this, minNode);
         }
 
         iterator end() {
@@ -243,7 +259,7 @@ namespace aisdi {
         }
 
         const_iterator cbegin() const {
-            return const_iterator(*this, minElement());
+            return const_iterator(*this, minNode);
         }
 
         const_iterator cend() const {
@@ -259,81 +275,198 @@ namespace aisdi {
         }
 
     private:
+        friend BalancePolicy;
+
         node_pointer root;
+        // Cached ends of the in-order list
+        node_pointer minNode;
+        node_pointer maxNode;
         size_type size;
+        size_type rotations;
+
+        void takeTree(TreeMap& other) {
+            root = other.root;
+            minNode = other.minNode;
+            maxNode = other.maxNode;
+            size = other.size;
+            other.root = other.minNode = other.maxNode = nullptr;
+            other.size = 0;
+        }
+
+        // Threads freshly attached leaf into in-order list next to its parent
+        void linkNode(node_pointer n) {
+            if (n->parent->leftChild == n) {
+                n->next = n->parent;
+                n->prev = n->parent->prev;
+            }
+            else {
+                n->prev = n->parent;
+                n->next = n->parent->next;
+            }
 
-        node_pointer minElement() const {
-            node_pointer element = root;
-            while (element != nullptr && element->leftChild != nullptr) {
-                element = element->leftChild;
+            if (n->prev != nullptr) {
+                n->prev->next = n;
+            }
+            else {
+                minNode = n;
+            }
+            if (n->next != nullptr) {
+                n->next->prev = n;
+            }
+            else {
+                maxNode = n;
             }
-            return element;
         }
 
-        node_pointer maxElement() const {
-            node_pointer element = root;
-            while (element != nullptr && element->rightChild != nullptr) {
-                element = element->rightChild;
+        void unlinkNode(node_pointer n) {
+            if (n->prev != nullptr) {
+                n->prev->next = n->next;
+            }
+            else {
+                minNode = n->next;
+            }
+            if (n->next != nullptr) {
+                n->next->prev = n->prev;
+            }
+            else {
+                maxNode = n->prev;
             }
-            return element;
         }
 
-        node_pointer override(node_pointer a, node_pointer b) {
-            auto newNode = new TreeNode(*b);
-            if (a->parent != nullptr) {
-                if (a->parent->leftChild == a) {
-                    a->parent->leftChild = newNode;
+        node_pointer attachNode(node_pointer n, node_pointer parent, bool asLeftChild) {
+            n->parent = parent;
+            ++size;
+            if (parent == nullptr) {
+                root = minNode = maxNode = n;
+            }
+            else {
+                if (asLeftChild) {
+                    parent->leftChild = n;
                 }
                 else {
-                    a->parent->rightChild = newNode;
+                    parent->rightChild = n;
                 }
+                linkNode(n);
             }
-            newNode->parent = a->parent;
-            if (a->leftChild != nullptr) {
-                a->leftChild->parent = newNode;
-            }
-            newNode->leftChild = a->leftChild;
-
-            if (a->rightChild != nullptr) {
-                a->rightChild->parent = newNode;
-            }
-            newNode->rightChild = a->rightChild;
-            delete(a);
-            return newNode;
+            BalancePolicy::afterInsert(*this, n);
+            return n;
         }
 
-        void rebalance(node_pointer balanceRoot) {
-            if (balanceRoot == nullptr) {
-                return;
+        // Returns node holding key or null, in which case parent and side of a free slot for key are set
+        node_pointer findSlotFromHint(node_pointer hint, const key_type& key, node_pointer& parent,
+                                      bool& asLeftChild) const {
+            if (root == nullptr) {
+                parent = nullptr;
+                return nullptr;
             }
 
-            balanceRoot->height = 1 + std::max(getHeight(balanceRoot->leftChild), getHeight(balanceRoot->rightChild));
-            auto balance = getBalance(balanceRoot);
-
-            if (balance == -2) {
-                if (getBalance(balanceRoot->leftChild) > 0) {
-                    balanceRoot->leftChild = rotateLeft(balanceRoot->leftChild);
+            if (hint == nullptr) {
+                // Appending past the largest key
+                if (maxNode->key() < key) {
+                    parent = maxNode;
+                    asLeftChild = false;
+                    return nullptr;
+                }
+                hint = maxNode;
+            }
+            else if (key < hint->key() && (hint->prev == nullptr || hint->prev->key() < key)) {
+                // Key belongs right before hint - either hint has a free left slot, or its predecessor
+                // has a free right one
+                if (hint->leftChild == nullptr) {
+                    parent = hint;
+                    asLeftChild = true;
+                }
+                else {
+                    parent = hint->prev;
+                    asLeftChild = false;
+                }
+                return nullptr;
+            }
+
+            return descend(climbTowards(hint, key), key, parent, asLeftChild);
+        }
+
+        // Climbs from n to the lowest ancestor whose subtree key range covers key
+        node_pointer climbTowards(node_pointer n, const key_type& key) const {
+            if (key < n->key()) {
+                while (true) {
+                    // Lower bound of n's subtree is the closest ancestor having n in its right subtree
+                    node_pointer bound = n;
+                    while (bound->parent != nullptr && bound->parent->leftChild == bound) {
+                        bound = bound->parent;
+                    }
+                    bound = bound->parent;
+                    if (bound == nullptr || bound->key() < key) {
+                        return n;
+                    }
+                    if (!(key < bound->key())) {
+                        return bound;
+                    }
+                    n = bound;
                 }
-                rotateRight(balanceRoot);
             }
-            else if (balance == 2) {
-                if (getBalance(balanceRoot->rightChild) < 0) {
-                    balanceRoot->rightChild = rotateRight(balanceRoot->rightChild);
+            if (n->key() < key) {
+                while (true) {
+                    node_pointer bound = n;
+                    while (bound->parent != nullptr && bound->parent->rightChild == bound) {
+                        bound = bound->parent;
+                    }
+                    bound = bound->parent;
+                    if (bound == nullptr || key < bound->key()) {
+                        return n;
+                    }
+                    if (!(bound->key() < key)) {
+                        return bound;
+                    }
+                    n = bound;
+                }
+            }
+            return n;
+        }
+
+        node_pointer descend(node_pointer n, const key_type& key, node_pointer& parent, bool& asLeftChild) const {
+            while (true) {
+                if (key < n->key()) {
+                    if (n->leftChild == nullptr) {
+                        parent = n;
+                        asLeftChild = true;
+                        return nullptr;
+                    }
+                    n = n->leftChild;
+                }
+                else if (n->key() < key) {
+                    if (n->rightChild == nullptr) {
+                        parent = n;
+                        asLeftChild = false;
+                        return nullptr;
+                    }
+                    n = n->rightChild;
+                }
+                else {
+                    return n;
                 }
-                rotateLeft(balanceRoot);
             }
+        }
 
-            if (balanceRoot->parent != nullptr) {
-                rebalance(balanceRoot->parent);
+        // Puts replacement (possibly null) in place of n as seen from n's parent
+        void replaceInParent(node_pointer n, node_pointer replacement) {
+            if (n->parent == nullptr) {
+                root = replacement;
+            }
+            else if (n->parent->leftChild == n) {
+                n->parent->leftChild = replacement;
             }
             else {
-                root = balanceRoot;
+                n->parent->rightChild = replacement;
+            }
+            if (replacement != nullptr) {
+                replacement->parent = n->parent;
             }
         }
 
         node_pointer rotateLeft(node_pointer rotationRoot) {
             node_pointer newRoot = rotationRoot->rightChild;
-            newRoot->parent = rotationRoot->parent;
+            replaceInParent(rotationRoot, newRoot);
             rotationRoot->rightChild = newRoot->leftChild;
 
             if (rotationRoot->rightChild != nullptr) {
@@ -342,25 +475,14 @@ namespace aisdi {
 
             newRoot->leftChild = rotationRoot;
             rotationRoot->parent = newRoot;
-
-            if (newRoot->parent != nullptr) {
-                if (newRoot->parent->leftChild == rotationRoot) {
-                    newRoot->parent->leftChild = newRoot;
-                }
-                else {
-                    newRoot->parent->rightChild = newRoot;
-                }
-            }
-
-            rotationRoot->height = std::max(getHeight(rotationRoot->leftChild), getHeight(rotationRoot->rightChild)) + 1;
-            newRoot->height = std::max(getHeight(newRoot->leftChild), getHeight(newRoot->rightChild)) + 1;
+            ++rotations;
 
             return newRoot;
         }
 
         node_pointer rotateRight(node_pointer rotationRoot) {
             node_pointer newRoot = rotationRoot->leftChild;
-            newRoot->parent = rotationRoot->parent;
+            replaceInParent(rotationRoot, newRoot);
             rotationRoot->leftChild = newRoot->rightChild;
 
             if (rotationRoot->leftChild != nullptr) {
@@ -369,44 +491,25 @@ namespace aisdi {
 
             newRoot->rightChild = rotationRoot;
             rotationRoot->parent = newRoot;
-
-            if (newRoot->parent != nullptr) {
-                if (newRoot->parent->rightChild == rotationRoot) {
-                    newRoot->parent->rightChild = newRoot;
-                }
-                else {
-                    newRoot->parent->leftChild = newRoot;
-                }
-            }
-
-            rotationRoot->height = std::max(getHeight(rotationRoot->leftChild), getHeight(rotationRoot->rightChild)) + 1;
-            newRoot->height = std::max(getHeight(newRoot->leftChild), getHeight(newRoot->rightChild)) + 1;
+            ++rotations;
 
             return newRoot;
         }
 
         void clearTree() {
-            auto it = begin();
-            while (it != end()) {
-                auto node = it.currentNode;
-                ++it;
+            auto node = minNode;
+            while (node != nullptr) {
+                auto next = node->next;
                 delete(node);
+                node = next;
             }
-            root = nullptr;
+            root = minNode = maxNode = nullptr;
             size = 0;
         }
-
-        inline int getHeight(node_pointer n) const {
-            return n == nullptr ? -1 : n->height;
-        }
-
-        inline int getBalance(node_pointer n) const {
-            return getHeight(n->rightChild) - getHeight(n->leftChild);
-        }
     };
 
-    template <typename KeyType, typename ValueType>
-    class TreeMap<KeyType, ValueType>::ConstIterator {
+    template <typename KeyType, typename ValueType, typename BalancePolicy>
+    class TreeMap<KeyType, ValueType, BalancePolicy>::ConstIterator {
     public:
         using reference = typename TreeMap::const_reference;
         using iterator_category = std::bidirectional_iterator_tag;
@@ -415,29 +518,22 @@ namespace aisdi {
 
         friend class TreeMap;
 
-        explicit ConstIterator(const TreeMap& parent, node_pointer currentNode) : parent(parent),
-                                                                                  currentNode(currentNode) {}
+        explicit ConstIterator(const TreeMap& tree, node_pointer currentNode) : tree(&tree),
+                                                                                currentNode(currentNode) {}
 
-        ConstIterator(const ConstIterator& other) : parent(other.parent), currentNode(other.currentNode) {}
+        ConstIterator(const ConstIterator& other) : tree(other.tree), currentNode(other.currentNode) {}
+
+        ConstIterator& operator=(const ConstIterator& other) {
+            tree = other.tree;
+            currentNode = other.currentNode;
+            return *this;
+        }
 
         ConstIterator& operator++() {
             if (currentNode == nullptr) {
                 throw std::out_of_range("Incrementing end iterator");
             }
-
-            if (currentNode->rightChild != nullptr) {
-                // One child right and then left till the end
-                currentNode = currentNode->rightChild;
-                while (currentNode->leftChild != nullptr) {
-                    currentNode = currentNode->leftChild;
-                }
-            }
-            else {
-                while (currentNode->parent != nullptr && currentNode->parent->rightChild == currentNode) {
-                    currentNode = currentNode->parent;
-                }
-                currentNode = currentNode->parent;
-            }
+            currentNode = currentNode->next;
             return *this;
         }
 
@@ -448,35 +544,13 @@ namespace aisdi {
         }
 
         ConstIterator& operator--() {
-            // Empty map -> begin == end -> no decrementing allowed
-            if (parent.isEmpty()) {
-                throw std::out_of_range("Decrementing begin iterator");
-            }
-
             // Decrementing end iterator
-            if (currentNode == nullptr) {
-                currentNode = parent.maxElement();
-                return *this;
-            }
-
-            node_pointer initialValue = currentNode;
-            if (currentNode->leftChild != nullptr) {
-                currentNode = currentNode->leftChild;
-                while (currentNode->rightChild != nullptr) {
-                    currentNode = currentNode->rightChild;
-                }
-            }
-            else {
-                while (currentNode->parent != nullptr && currentNode->parent->leftChild == currentNode) {
-                    currentNode = currentNode->parent;
-                }
-                if (currentNode->parent == nullptr) {
-                    // Decrementing begin operator
-                    currentNode = initialValue;
-                    throw std::out_of_range("Decrementing begin iterator");
-                }
-                currentNode = currentNode->parent;
+            node_pointer previous = currentNode == nullptr ? tree->maxNode : currentNode->prev;
+            if (previous == nullptr) {
+                // Decrementing begin iterator (or end of empty map)
+                throw std::out_of_range("Decrementing begin iterator");
             }
+            currentNode = previous;
             return *this;
         }
 
@@ -506,17 +580,18 @@ namespace aisdi {
         }
 
     private:
-        const TreeMap& parent;
+        const TreeMap* tree;
         node_pointer currentNode;
     };
 
-    template <typename KeyType, typename ValueType>
-    class TreeMap<KeyType, ValueType>::Iterator : public TreeMap<KeyType, ValueType>::ConstIterator {
+    template <typename KeyType, typename ValueType, typename BalancePolicy>
+    class TreeMap<KeyType, ValueType, BalancePolicy>::Iterator
+            : public TreeMap<KeyType, ValueType, BalancePolicy>::ConstIterator {
     public:
         using reference = typename TreeMap::reference;
         using pointer = typename TreeMap::value_type*;
 
-        explicit Iterator(const TreeMap& parent, node_pointer currentNode) : ConstIterator(parent, currentNode) {}
+        explicit Iterator(const TreeMap& tree, node_pointer currentNode) : ConstIterator(tree, currentNode) {}
 
         Iterator(const ConstIterator& other)
                 : ConstIterator(other) {}
@@ -0,0 +1,86 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "TreeMap.h"
+#include "bench/Benchmark.h"
+
+namespace aisdi {
+namespace bench {
+
+namespace
+{
+
+    struct Mix {
+        const char* name;
+        // Percentages of the operation stream, the rest are lookups
+        unsigned insertPercent;
+        unsigned removePercent;
+    };
+
+    struct Result {
+        double opsPerSecond;
+        double rotationsPerKiloOp;
+    };
+
+    template <typename Policy>
+    Result runMix(const Mix& mix, std::size_t count) {
+        TreeMap<int, int, Policy> map;
+        std::mt19937 random(42);
+        const int keyRange = static_cast<int>(2 * count);
+        for (std::size_t i = 0; i < count; ++i)
+            map[random() % keyRange] = 0;
+
+        const std::size_t rotationsBefore = map.getRotationCount();
+        std::size_t found = 0;
+        Stopwatch stopwatch;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const int key = random() % keyRange;
+            const unsigned dice = random() % 100;
+            if (dice < mix.insertPercent)
+                map[key] = 1;
+            else if (dice < mix.insertPercent + mix.removePercent)
+            {
+                auto it = map.find(key);
+                if (it != map.end())
+                    map.remove(it);
+            }
+            else
+                found += map.find(key) != map.end();
+        }
+        const double elapsedNs = stopwatch.elapsedNs();
+        doNotOptimize(found);
+
+        return { count / elapsedNs * 1e9,
+                 1000.0 * (map.getRotationCount() - rotationsBefore) / count };
+    }
+
+} // namespace
+
+int balancingBenchmark(int argc, char** argv) {
+    const std::size_t count = sizeArgument(argc, argv, 1, 1000000);
+    const Mix mixes[] = {
+        { "insert-heavy", 70, 10 },
+        { "delete-heavy", 30, 60 },
+        { "lookup-heavy", 5, 5 },
+    };
+
+    std::printf("%-14s %-10s %14s %16s\n", "mix", "policy", "Mops/s", "rotations/kop");
+    for (const auto& mix : mixes)
+    {
+        const Result results[] = {
+            runMix<AvlBalance>(mix, count),
+            runMix<RedBlackBalance>(mix, count),
+            runMix<WeakAvlBalance>(mix, count),
+        };
+        const char* names[] = { "avl", "red-black", "wavl" };
+        for (int i = 0; i < 3; ++i)
+            std::printf("%-14s %-10s %14.2f %16.1f\n", mix.name, names[i],
+                        results[i].opsPerSecond / 1e6, results[i].rotationsPerKiloOp);
+    }
+    return 0;
+}
+
+} // namespace bench
+} // namespace aisdi
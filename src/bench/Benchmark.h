@@ -0,0 +1,47 @@
+#ifndef AISDI_MAPS_BENCHMARK_H
+#define AISDI_MAPS_BENCHMARK_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+
+namespace aisdi {
+namespace bench {
+
+    class Stopwatch {
+    public:
+        using clock = std::chrono::steady_clock;
+
+        Stopwatch() : start(clock::now()) {}
+
+        void restart() {
+            start = clock::now();
+        }
+
+        double elapsedNs() const {
+            return std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        }
+
+    private:
+        clock::time_point start;
+    };
+
+    // Keeps the optimizer from discarding a computed value
+    template <typename T>
+    inline void doNotOptimize(const T& value) {
+        asm volatile("" : : "g"(&value) : "memory");
+    }
+
+    inline std::size_t sizeArgument(int argc, char** argv, int index, std::size_t defaultValue) {
+        return argc > index ? static_cast<std::size_t>(std::atoll(argv[index])) : defaultValue;
+    }
+
+    // Scenarios runnable as `aisdiMaps <name> [args...]`, argv[0] being the scenario name
+    int hintedInsertBenchmark(int argc, char** argv);
+    int balancingBenchmark(int argc, char** argv);
+    int frozenLookupBenchmark(int argc, char** argv);
+
+} // namespace bench
+} // namespace aisdi
+
+#endif /* AISDI_MAPS_BENCHMARK_H */
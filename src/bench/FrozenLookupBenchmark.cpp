@@ -0,0 +1,55 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "TreeMap.h"
+#include "bench/Benchmark.h"
+
+namespace aisdi {
+namespace bench {
+
+namespace
+{
+
+    template <typename Map>
+    double lookupNs(const Map& map, const std::vector<int>& probes) {
+        long long sum = 0;
+        Stopwatch stopwatch;
+        for (int key : probes)
+            sum += map.valueOf(key);
+        const double elapsedNs = stopwatch.elapsedNs();
+        doNotOptimize(sum);
+        return elapsedNs / probes.size();
+    }
+
+} // namespace
+
+int frozenLookupBenchmark(int argc, char** argv) {
+    const std::size_t count = sizeArgument(argc, argv, 1, 1000000);
+    const std::size_t probeCount = sizeArgument(argc, argv, 2, 1000000);
+
+    std::vector<int> keys(count);
+    for (std::size_t i = 0; i < count; ++i)
+        keys[i] = static_cast<int>(3 * i);
+    std::mt19937 random(42);
+    std::shuffle(keys.begin(), keys.end(), random);
+
+    TreeMap<int, int> map;
+    for (int key : keys)
+        map[key] = key;
+    const auto frozen = map.freeze();
+
+    std::vector<int> probes(probeCount);
+    for (auto& probe : probes)
+        probe = keys[random() % count];
+
+    const double treeNs = lookupNs(map, probes);
+    const double frozenNs = lookupNs(frozen, probes);
+    std::printf("%-10s %12s %12s %10s\n", "keys", "TreeMap ns", "frozen ns", "speedup");
+    std::printf("%-10zu %12.1f %12.1f %9.2fx\n", count, treeNs, frozenNs, treeNs / frozenNs);
+    return 0;
+}
+
+} // namespace bench
+} // namespace aisdi
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "TreeMap.h"
+#include "bench/Benchmark.h"
+
+namespace aisdi {
+namespace bench {
+
+namespace
+{
+
+    using Map = TreeMap<int, int>;
+
+    std::vector<int> monotonicKeys(std::size_t count) {
+        std::vector<int> keys(count);
+        for (std::size_t i = 0; i < count; ++i)
+            keys[i] = static_cast<int>(i);
+        return keys;
+    }
+
+    // Sorted stream where about one key in a hundred arrives a few positions late
+    std::vector<int> nearlySortedKeys(std::size_t count) {
+        std::vector<int> keys = monotonicKeys(count);
+        std::mt19937 random(42);
+        for (std::size_t i = 0; i + 8 < count; i += 100)
+            std::swap(keys[i], keys[i + 1 + random() % 7]);
+        return keys;
+    }
+
+    std::vector<int> randomKeys(std::size_t count) {
+        std::vector<int> keys = monotonicKeys(count);
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+        return keys;
+    }
+
+    double plainInsertNs(const std::vector<int>& keys) {
+        Map map;
+        Stopwatch stopwatch;
+        for (int key : keys)
+            map[key] = key;
+        doNotOptimize(map);
+        return stopwatch.elapsedNs() / keys.size();
+    }
+
+    double hintedInsertNs(const std::vector<int>& keys) {
+        Map map;
+        Stopwatch stopwatch;
+        for (int key : keys)
+            map.emplaceHint(map.end(), key, key);
+        doNotOptimize(map);
+        return stopwatch.elapsedNs() / keys.size();
+    }
+
+} // namespace
+
+int hintedInsertBenchmark(int argc, char** argv) {
+    const std::size_t count = sizeArgument(argc, argv, 1, 1000000);
+    const struct {
+        const char* name;
+        std::vector<int> keys;
+    } orders[] = {
+        { "monotonic", monotonicKeys(count) },
+        { "nearly-sorted", nearlySortedKeys(count) },
+        { "random", randomKeys(count) },
+    };
+
+    std::printf("%-14s %16s %16s\n", "order", "operator[] ns", "emplaceHint ns");
+    for (const auto& order : orders)
+        std::printf("%-14s %16.1f %16.1f\n", order.name, plainInsertNs(order.keys), hintedInsertNs(order.keys));
+    return 0;
+}
+
+} // namespace bench
+} // namespace aisdi
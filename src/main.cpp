@@ -1,5 +1,6 @@
 #include <cstddef>
 #include <cstdlib>
+#include <cstring>
 #include <string>
 #include <iostream>
 #include <list>
@@ -7,6 +8,7 @@
 
 #include "TreeMap.h"
 #include "HashMap.h"
+#include "bench/Benchmark.h"
 
 namespace
 {
@@ -20,10 +22,28 @@ namespace
         map.remove(753);
     }
 
+    const struct {
+        const char* name;
+        int (*run)(int argc, char** argv);
+    } scenarios[] = {
+        { "hinted-insert", aisdi::bench::hintedInsertBenchmark },
+        { "balancing", aisdi::bench::balancingBenchmark },
+        { "frozen-lookup", aisdi::bench::frozenLookupBenchmark },
+    };
+
 } // namespace
 
 int main(int argc, char** argv)
 {
+    if (argc > 1)
+    {
+        for (const auto& scenario : scenarios)
+        {
+            if (std::strcmp(argv[1], scenario.name) == 0)
+                return scenario.run(argc - 1, argv + 1);
+        }
+    }
+
     const std::size_t repeatCount = argc > 1 ? std::atoll(argv[1]) : 1;
     for (std::size_t i = 0; i < repeatCount; ++i)
         perfomTest();
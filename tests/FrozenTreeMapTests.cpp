@@ -0,0 +1,110 @@
+#include <TreeMap.h>
+
+#include <cstdint>
+#include <string>
+#include <map>
+
+#include <boost/test/unit_test.hpp>
+
+#include <boost/mpl/list.hpp>
+
+template <typename K>
+using Map = aisdi::TreeMap<K, std::string>;
+
+using TestedKeyTypes = boost::mpl::list<std::int32_t, std::uint64_t>;
+
+BOOST_AUTO_TEST_SUITE(FrozenTreeMapTests)
+
+template <typename K>
+std::map<K, std::string> givenItems(int count)
+{
+  std::map<K, std::string> items;
+  for (int i = 0; i < count; ++i)
+    items[2 * i + 1] = std::to_string(i);
+  return items;
+}
+
+template <typename K>
+Map<K> givenMap(const std::map<K, std::string>& items)
+{
+  Map<K> map;
+  for (const auto& item : items)
+    map[item.first] = item.second;
+  return map;
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenFreezing_ThenIndexIsEmpty,
+                              K,
+                              TestedKeyTypes)
+{
+  const Map<K> map;
+
+  const auto frozen = map.freeze();
+
+  BOOST_CHECK(frozen.isEmpty());
+  BOOST_CHECK(frozen.begin() == frozen.end());
+  BOOST_CHECK(frozen.find(1) == frozen.end());
+  BOOST_CHECK_THROW(frozen.valueOf(1), std::out_of_range);
+  BOOST_CHECK_THROW(--frozen.end(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFrozenMap_WhenSearchingForKeys_ThenAllItemsAreFound,
+                              K,
+                              TestedKeyTypes)
+{
+  for (int count : { 1, 2, 3, 7, 8, 100 })
+  {
+    const auto items = givenItems<K>(count);
+    const auto frozen = givenMap(items).freeze();
+
+    BOOST_CHECK_EQUAL(frozen.getSize(), items.size());
+    for (const auto& item : items)
+    {
+      const auto it = frozen.find(item.first);
+      BOOST_REQUIRE(it != frozen.end());
+      BOOST_CHECK_EQUAL(it->first, item.first);
+      BOOST_CHECK_EQUAL(frozen.valueOf(item.first), item.second);
+      BOOST_CHECK(frozen.find(item.first + 1) == frozen.end());
+    }
+    BOOST_CHECK(frozen.find(0) == frozen.end());
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFrozenMap_WhenSearchingForLowerBound_ThenFirstNotSmallerItemIsReturned,
+                              K,
+                              TestedKeyTypes)
+{
+  const auto frozen = givenMap(givenItems<K>(10)).freeze();
+
+  BOOST_CHECK_EQUAL(frozen.lowerBound(0)->first, 1);
+  BOOST_CHECK_EQUAL(frozen.lowerBound(5)->first, 5);
+  BOOST_CHECK_EQUAL(frozen.lowerBound(6)->first, 7);
+  BOOST_CHECK(frozen.lowerBound(20) == frozen.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFrozenMap_WhenIterating_ThenItemsAreInOrder,
+                              K,
+                              TestedKeyTypes)
+{
+  for (int count : { 1, 5, 16, 31, 100 })
+  {
+    const auto items = givenItems<K>(count);
+    const auto frozen = givenMap(items).freeze();
+
+    auto expectedIt = items.begin();
+    for (auto it = frozen.begin(); it != frozen.end(); ++it, ++expectedIt)
+    {
+      BOOST_CHECK_EQUAL((*it).first, expectedIt->first);
+      BOOST_CHECK_EQUAL((*it).second, expectedIt->second);
+    }
+    BOOST_CHECK(expectedIt == items.end());
+
+    auto reverseIt = items.rbegin();
+    for (auto it = frozen.end(); it != frozen.begin(); ++reverseIt)
+      BOOST_CHECK_EQUAL((--it)->first, reverseIt->first);
+    BOOST_CHECK_THROW(--frozen.begin(), std::out_of_range);
+    BOOST_CHECK_THROW(++frozen.end(), std::out_of_range);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
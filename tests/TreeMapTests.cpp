@@ -786,6 +786,143 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoMapsWithDifferentKeys_WhenComparingThem_Th
   BOOST_CHECK(map != other);
 }
 
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMapAfterInsertionsAndRemovals_WhenIterating_ThenItemsAreInOrder,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+  for (int i = 0; i < 64; ++i)
+  {
+    const int key = (i * 37) % 64;
+    map[key] = std::to_string(key);
+    expected[key] = std::to_string(key);
+  }
+  for (int key = 0; key < 64; key += 3)
+  {
+    map.remove(key);
+    expected.erase(key);
+  }
+
+  thenMapContainsItems(map, expected);
+  auto expectedIt = expected.begin();
+  for (auto it = map.begin(); it != map.end(); ++it, ++expectedIt)
+    BOOST_CHECK_EQUAL(it->first, expectedIt->first);
+  auto reverseIt = expected.rbegin();
+  for (auto it = map.end(); it != map.begin(); ++reverseIt)
+    BOOST_CHECK_EQUAL((--it)->first, reverseIt->first);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenRemovingSmallestAndLargestItems_ThenBeginAndEndFollow,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 1, "A" }, { 2, "B" }, { 3, "C" }, { 4, "D" } };
+
+  map.remove(1);
+  map.remove(4);
+
+  BOOST_CHECK_EQUAL(map.begin()->first, 2);
+  BOOST_CHECK_EQUAL((--map.end())->first, 3);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyMap_WhenAppendingWithEndHint_ThenItemsAreInMap,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+
+  for (int key = 0; key < 32; ++key)
+    map.emplaceHint(map.end(), key, std::to_string(key));
+
+  std::map<K, std::string> expected;
+  for (int key = 0; key < 32; ++key)
+    expected[key] = std::to_string(key);
+  thenMapContainsItems(map, expected);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenInsertingWithArbitraryHints_ThenItemsAreInMap,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map;
+  std::map<K, std::string> expected;
+
+  for (int i = 0; i < 64; ++i)
+  {
+    const int key = (i * 29) % 64;
+    auto hint = map.find((i * 13) % 64);
+    const auto it = map.insert(hint, key, std::to_string(key));
+    expected[key] = std::to_string(key);
+    BOOST_CHECK_EQUAL(it->first, key);
+  }
+
+  thenMapContainsItems(map, expected);
+  auto expectedIt = expected.begin();
+  for (auto it = map.begin(); it != map.end(); ++it, ++expectedIt)
+    BOOST_CHECK_EQUAL(it->first, expectedIt->first);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenMap_WhenInsertingExistingKeyWithHint_ThenValueIsNotChanged,
+                              K,
+                              TestedKeyTypes)
+{
+  Map<K> map = { { 42, "Alice" }, { 27, "Bob" } };
+
+  const auto it = map.insert(map.begin(), 42, "Chuck");
+
+  BOOST_CHECK(it == map.find(42));
+  thenMapContainsItems(map, { { 42, "Alice" }, { 27, "Bob" } });
+}
+
+using TestedBalancePolicies = boost::mpl::list<aisdi::AvlBalance, aisdi::RedBlackBalance, aisdi::WeakAvlBalance>;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenBalancePolicy_WhenInsertingAndRemovingManyItems_ThenMapMatchesReference,
+                              P,
+                              TestedBalancePolicies)
+{
+  aisdi::TreeMap<int, int, P> map;
+  std::map<int, int> expected;
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    const int key = (i * 7919) % 512;
+    if (i % 3 == 2)
+    {
+      if (expected.erase(key))
+        map.remove(key);
+    }
+    else
+    {
+      map[key] = i;
+      expected[key] = i;
+    }
+  }
+
+  BOOST_CHECK_EQUAL(map.getSize(), expected.size());
+  auto expectedIt = expected.begin();
+  for (auto it = map.begin(); it != map.end(); ++it, ++expectedIt)
+  {
+    BOOST_CHECK_EQUAL(it->first, expectedIt->first);
+    BOOST_CHECK_EQUAL(it->second, expectedIt->second);
+  }
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenBalancePolicy_WhenInsertingSortedKeys_ThenTreeIsRotated,
+                              P,
+                              TestedBalancePolicies)
+{
+  aisdi::TreeMap<int, int, P> map;
+
+  for (int key = 0; key < 16; ++key)
+    map[key] = key;
+  while (!map.isEmpty())
+    map.remove(map.begin());
+
+  BOOST_CHECK(map.getRotationCount() > 0);
+  BOOST_CHECK(map.begin() == map.end());
+}
+
 // ConstIterator is tested via Iterator methods.
 // If Iterator methods are to be changed, then new ConstIterator tests are required.
 